@@ -3,9 +3,17 @@
 # test-performance.sh - Performance data collection for touch-timeout daemon
 #
 # PURPOSE:
-#   Measures CPU usage, memory consumption, SD card writes, and file descriptor
-#   leaks over a specified duration. Outputs machine-readable metrics for
-#   verification against performance targets.
+#   Measures CPU usage, memory consumption, SD card writes, file descriptor
+#   leaks and wakeups over a specified duration. Outputs machine-readable
+#   metrics for verification against performance targets.
+#
+#   Wakeups are voluntary context switches (each return from blocking poll()).
+#   To measure a specific state (e.g. DIMMED), start the run after the display
+#   has dimmed (plus --align seconds) and keep the duration shorter than the
+#   remaining off timeout. Use a window of minutes: WAKEUPS_PER_HOUR is a
+#   linear extrapolation, so a short window containing one transition reports
+#   a meaningless rate (1 wakeup in 20s = 180/h).
+#   Compare with and without --slack/--align to see timer batching effects.
 #
 # DEPENDENCIES:
 #   Standard tools only: ps, awk, ls, sleep, date (no external packages)
@@ -15,6 +23,7 @@
 #   - Memory: <0.5 MB RSS (static binary, no allocation)
 #   - SD writes: 0 bytes (no logging to disk during operation)
 #   - FD delta: 0 (no file descriptor leaks)
+#   - Wakeups: only on state transitions, touch or external wake
 #
 # USAGE:
 #
@@ -85,6 +94,7 @@ get_mem_kb() {
 mem_start=$(get_mem_kb "$pid")
 fd_start=$(ls /proc/$pid/fd 2>/dev/null | wc -l)
 write_start=$(awk '/^write_bytes:/ {print $2; exit}' /proc/$pid/io 2>/dev/null || echo "N/A")
+wake_start=$(awk '/^voluntary_ctxt_switches:/ {print $2; exit}' /proc/$pid/status 2>/dev/null || echo "N/A")
 
 # Collect CPU samples (progress dots instead of per-line output)
 echo -n "# Collecting CPU samples (${DURATION}s): "
@@ -112,6 +122,7 @@ echo " done"
 mem_end=$(get_mem_kb "$pid")
 fd_end=$(ls /proc/$pid/fd 2>/dev/null | wc -l)
 write_end=$(awk '/^write_bytes:/ {print $2; exit}' /proc/$pid/io 2>/dev/null || echo "N/A")
+wake_end=$(awk '/^voluntary_ctxt_switches:/ {print $2; exit}' /proc/$pid/status 2>/dev/null || echo "N/A")
 
 # Calculate metrics (strip non-digits for safety - handles unexpected ps output)
 mem_start_safe=${mem_start//[^0-9]/}; mem_start_safe=${mem_start_safe:-0}
@@ -137,5 +148,13 @@ if [[ "$write_start" != "N/A" && "$write_end" != "N/A" ]]; then
 else
     echo "SD_WRITE_BYTES=N/A"
 fi
+if [[ -n "$wake_start" && -n "$wake_end" && "$wake_start" != "N/A" && "$wake_end" != "N/A" ]]; then
+    wakeups=$((wake_end - wake_start))
+    echo "WAKEUPS=$wakeups"
+    echo "WAKEUPS_PER_HOUR=$(awk "BEGIN {printf \"%.1f\", $wakeups * 3600 / $DURATION}")"
+else
+    echo "WAKEUPS=N/A"
+    echo "WAKEUPS_PER_HOUR=N/A"
+fi
 echo ""
 echo "# Targets: CPU ~0%, Memory <0.5MB, SD writes = 0, FD delta = 0"
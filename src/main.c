@@ -16,7 +16,37 @@
  *   2. On POLLIN: drain_touch_events() → state_touch() → set_brightness() if changed
  *   3. On timeout: state_timeout() → set_brightness() if changed
  *   4. On SIGUSR1: state_touch() to wake display (external integration)
- *   5. On SIGTERM/SIGINT: g_running=false → cleanup → exit
+ *   5. On wake socket POLLIN: hand client its own wake fd (SCM_RIGHTS)
+ *   6. On wake fd POLLIN: drain wake fd → state_touch() (external integration)
+ *   7. On inotify POLLIN: matching trigger file event → state_touch()
+ *   8. On SIGTERM/SIGINT: g_running=false → cleanup → exit
+ *
+ * EXTERNAL WAKE SOURCES:
+ *   SIGUSR1 needs access to the host PID namespace. For containers, the
+ *   optional wake socket (-w) hands each client one end of its own
+ *   SOCK_SEQPACKET socketpair; each client wake is a single 8-byte write()
+ *   that lands in our poll set. Our ends are never shared, so a client cannot
+ *   block our read() or consume another client's wake. Unlike a pipe, writing
+ *   after we drop our end fails with EPIPE/ECONNRESET instead of raising
+ *   SIGPIPE in the client. WAKE_CLIENT_SLOTS bounds the poll set:
+ *   slots free on hangup, and the oldest client is evicted when all are in use.
+ *   Containers that can only share a directory use the optional wake file
+ *   (-f): inotify on the parent directory, so `touch PATH` wakes the display.
+ *   Directory watches survive the trigger file being deleted and recreated.
+ *
+ * TIMER TOLERANCE:
+ *   Dim/off deadlines tolerate seconds of delay. --slack sets PR_SET_TIMERSLACK
+ *   so the kernel may defer our poll() expiry to coincide with other timers;
+ *   --align rounds each deadline up to a multiple of N seconds on
+ *   CLOCK_MONOTONIC, a boundary shared by every process on the system.
+ *
+ * EARLY-BOOT HANDOFF:
+ *   With --early the daemon runs from initramfs (no udev, /run or systemd
+ *   needed: devtmpfs and sysfs only) and listens on an abstract Unix socket,
+ *   which needs no filesystem and survives switch_root. The service instance
+ *   connects at startup and receives state, panel brightness and the open
+ *   backlight/input fds (SCM_RIGHTS); the early instance exits without
+ *   touching brightness, so the panel does not flicker.
  *
  * MODULE INTERFACE:
  *   Calls state.c API - pure functions where caller provides timestamps.
@@ -27,7 +57,7 @@
  *   CLI options (-l, -i) override auto-detection.
  *
  * TESTING:
- *   Unit tests: tests/test_state.c (tests state machine only)
+ *   Unit tests: tests/test_state.c (state machine, config, wake and fd passing I/O)
  *   Integration tests: scripts/test-integration.sh (device deployment validation)
  *   This file is included by test_state.c with UNIT_TEST guard to test static functions
  *
@@ -52,6 +82,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -65,10 +96,15 @@
 #include <poll.h>
 #include <signal.h>
 #include <sys/ioctl.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <unistd.h>
 
 /* Linux-specific */
 #include <linux/input.h>
+#include <sys/inotify.h>
 
 /* Systemd notification support */
 #ifdef HAVE_SYSTEMD
@@ -96,11 +132,23 @@ static inline int sd_notify(int unset_environment, const char *state) {
 #define MAX_DIM_PERCENT      100
 #define MIN_DIM_BRIGHTNESS   10
 #define MIN_DIM_TIMEOUT_SEC  1
+#define MIN_SLACK_MS         0      /* 0 = kernel default (50 us) */
+#define MAX_SLACK_MS         4000
+#define MIN_ALIGN_SEC        0      /* 0 = no deadline alignment */
+#define MAX_ALIGN_SEC        3600
 
 /* Ensure timeout fits in poll() int parameter */
 _Static_assert(MAX_TIMEOUT_SEC <= INT_MAX / 1000,
                "MAX_TIMEOUT_SEC too large for poll() timeout");
 
+/* Ensure aligned timeout (timeout + up to one boundary) fits in poll() int */
+_Static_assert(MAX_TIMEOUT_SEC + MAX_ALIGN_SEC <= INT_MAX / 1000,
+               "MAX_TIMEOUT_SEC + MAX_ALIGN_SEC too large for poll() timeout");
+
+/* Ensure slack in ns fits PR_SET_TIMERSLACK unsigned long on 32-bit ARM */
+_Static_assert(MAX_SLACK_MS * 1000000ULL <= 0xFFFFFFFFULL,
+               "MAX_SLACK_MS overflows 32-bit timer slack");
+
 /* Ensure brightness * dim_percent fits in int */
 _Static_assert(MAX_BRIGHTNESS * MAX_DIM_PERCENT <= INT_MAX,
                "MAX_BRIGHTNESS * MAX_DIM_PERCENT overflow risk");
@@ -117,11 +165,34 @@ _Static_assert(MAX_BRIGHTNESS * MAX_DIM_PERCENT <= INT_MAX,
 /* Path buffer: dir + "/" + name + "/max_brightness" + null */
 #define PATH_BUFFER_LEN      (sizeof(SYSFS_BACKLIGHT_PATH) + 1 + MAX_DEVICE_NAME_LEN + 16)
 
+/* Wake paths (socket and trigger file): must fit in sockaddr_un.sun_path (108 on Linux) */
+#define WAKE_PATH_LEN        108
+#define WAKE_SOCKET_BACKLOG  4
+#define WAKE_SOCKET_MODE     0660   /* Owner root, group from --wake-gid */
+#define WAKE_CLIENT_SLOTS    8
+#define WAKE_DRAIN_LEN       64
+#define WAKE_FILE_MODE       0660   /* Owner root, group from --wake-gid */
+
+/* Max fds passed in one SCM_RIGHTS message (handoff: backlight + input) */
+#define MAX_PASSED_FDS       2
+
+/* Early-boot handoff: abstract socket name (no leading NUL here) */
+#define HANDOFF_SOCKET_NAME  "touch-timeout-handoff"
+#define HANDOFF_MAGIC        0x54544831U  /* "TTH1" */
+#define HANDOFF_TIMEOUT_SEC  1    /* Per connect/recv attempt */
+#define HANDOFF_MAX_WAIT_SEC 10   /* Total wait while an early instance listens */
+#define HANDOFF_RETRY_MS     100
+
+/* Trigger file events: `touch` (create or existing), write+close, rename into place */
+#define WAKE_FILE_MASK       (IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_TO)
+
 /* Compile-time buffer safety checks */
 _Static_assert(PATH_BUFFER_LEN >= sizeof(SYSFS_BACKLIGHT_PATH) + 1 + MAX_DEVICE_NAME_LEN + sizeof("/max_brightness"),
                "PATH_BUFFER_LEN too small for backlight paths");
 _Static_assert(PATH_BUFFER_LEN >= sizeof(DEV_INPUT_PATH) + 1 + MAX_DEVICE_NAME_LEN,
                "PATH_BUFFER_LEN too small for input paths");
+_Static_assert(WAKE_PATH_LEN <= sizeof(((struct sockaddr_un *)0)->sun_path),
+               "WAKE_PATH_LEN exceeds sockaddr_un.sun_path");
 
 /* Device auto-detection */
 
@@ -139,10 +210,38 @@ typedef struct {
     int brightness;
     int timeout_sec;
     int dim_percent;
+    int slack_ms;
+    int align_sec;
     char backlight[MAX_DEVICE_NAME_LEN];
     char device[MAX_DEVICE_NAME_LEN];
+    char wake_socket[WAKE_PATH_LEN];  /* Empty = wake socket disabled */
+    char wake_file[WAKE_PATH_LEN];    /* Empty = wake file disabled */
+    int wake_gid;                     /* Group for wake socket/file, -1 = unchanged */
+    bool early;                       /* Early-boot (initramfs) instance */
 } config_s;
 
+/* External wake sources (fd = -1 when disabled) */
+
+typedef struct {
+    int socket_fd;   /* Listening Unix socket that hands out wake fds */
+    int client_fds[WAKE_CLIENT_SLOTS];  /* Our socketpair ends, -1 = free slot */
+    uint64_t client_seq[WAKE_CLIENT_SLOTS];  /* Connect order, lowest evicted first */
+    uint64_t next_seq;  /* Sequence number for the next client */
+    int inotify_fd;  /* Watch on trigger file's directory */
+    char watch_name[WAKE_PATH_LEN];  /* Trigger file name, empty = any entry */
+} wake_s;
+
+/* Early-boot handoff message, followed by backlight and input fds */
+
+typedef struct {
+    uint32_t magic;           /* HANDOFF_MAGIC */
+    uint32_t state;           /* state_e at handoff */
+    uint32_t last_touch_sec;  /* CLOCK_MONOTONIC, shared across processes */
+    int32_t brightness;       /* Brightness currently on the panel */
+    char backlight[MAX_DEVICE_NAME_LEN];
+    char device[MAX_DEVICE_NAME_LEN];
+} handoff_s;
+
 /* Global state */
 
 static volatile sig_atomic_t g_running = 1;
@@ -169,6 +268,13 @@ static uint32_t now_sec(void) {
     return (uint32_t)ts.tv_sec;
 }
 
+/* Get current time in milliseconds (CLOCK_MONOTONIC), for deadline alignment */
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U;
+}
+
 /* Parse integer from string, returns -1 on error */
 static int parse_int(const char *str, int *out) {
     char *end;
@@ -213,6 +319,22 @@ static void calculate_timeouts(uint32_t timeout_sec, int dim_percent,
     }
 }
 
+/*
+ * Round poll() timeout so the deadline lands on a multiple of align_ms
+ *
+ * Deadline now_ms + timeout_ms is rounded up (never earlier than requested).
+ * Returns timeout_ms unchanged if infinite (-1) or align_ms is 0.
+ * Caller ensures timeout_ms + align_ms fits in int (see _Static_assert).
+ */
+static int align_timeout_ms(uint64_t now_ms, int timeout_ms, uint32_t align_ms) {
+    if (timeout_ms < 0 || align_ms == 0)
+        return timeout_ms;
+
+    uint64_t deadline = now_ms + (uint64_t)timeout_ms;
+    uint64_t aligned = ((deadline + align_ms - 1) / align_ms) * align_ms;
+    return (int)(aligned - now_ms);
+}
+
 /* CLI argument parsing */
 
 static void usage(const char *prog) {
@@ -223,8 +345,15 @@ static void usage(const char *prog) {
         "  -b, --brightness=N   Full brightness (15-255, default %d)\n"
         "  -t, --timeout=N      Off timeout in seconds (10-86400, default %d)\n"
         "  -d, --dim-percent=N  Dim at N%% of timeout (1-100, default %d)\n"
+        "  -s, --slack=MS       Timer slack for dim/off wakeups (0-4000, default 0)\n"
+        "  -a, --align=SEC      Round dim/off deadlines up to N-second boundary (0-3600)\n"
         "  -l, --backlight=NAME Backlight device (auto-detect, fallback %s)\n"
         "  -i, --input=NAME     Input device (auto-detect, fallback %s)\n"
+        "  -w, --wake-socket=PATH\n"
+        "                       Hand out wake fds on Unix socket PATH\n"
+        "  -g, --wake-gid=GID   Group allowed to use the wake socket and file\n"
+        "  -f, --wake-file=PATH Wake when PATH is touched (or any file, if a directory)\n"
+        "  -e, --early          Early-boot mode (initramfs), hand over to service instance\n"
         "  -v, --verbose        Verbose logging\n"
         "  -V, --version        Show version\n"
         "  -h, --help           Show this help\n"
@@ -232,7 +361,12 @@ static void usage(const char *prog) {
         "Devices are auto-detected at startup. Use -l/-i to override.\n"
         "\n"
         "External wake: Send SIGUSR1 to wake display\n"
-        "  pkill -USR1 touch-timeout\n",
+        "  pkill -USR1 touch-timeout\n"
+        "Or connect to the wake socket, receive a wake fd (SCM_RIGHTS),\n"
+        "and write an 8-byte counter to it for each wake. EAGAIN means a\n"
+        "wake is already pending: ignore it, do not reconnect. Reconnect on\n"
+        "EPIPE/ECONNRESET; the fd never raises SIGPIPE.\n"
+        "Or touch the wake file: touch /run/touch-timeout/wake\n",
         prog, DEFAULT_BRIGHTNESS, DEFAULT_TIMEOUT_SEC, DEFAULT_DIM_PERCENT,
         DEFAULT_BACKLIGHT, DEFAULT_DEVICE);
 }
@@ -247,6 +381,18 @@ static bool validate_device_name(const char *name) {
     return true;
 }
 
+/*
+ * Validate wake socket/file path: absolute, no "..", fits in sun_path.
+ */
+static bool validate_wake_path(const char *path) {
+    if (path[0] != '/' || strstr(path, "..") != NULL)
+        return false;
+    size_t len = strlen(path);
+    if (len < 2 || len >= WAKE_PATH_LEN)
+        return false;
+    return true;
+}
+
 /*
  * Auto-detect backlight device by scanning /sys/class/backlight/
  * Returns true if found, writing device name to out buffer.
@@ -332,8 +478,14 @@ static void parse_args(int argc, char **argv, config_s *cfg) {
         {"brightness",  required_argument, 0, 'b'},
         {"timeout",     required_argument, 0, 't'},
         {"dim-percent", required_argument, 0, 'd'},
+        {"slack",       required_argument, 0, 's'},
+        {"align",       required_argument, 0, 'a'},
         {"backlight",   required_argument, 0, 'l'},
         {"input",       required_argument, 0, 'i'},
+        {"wake-socket", required_argument, 0, 'w'},
+        {"wake-gid",    required_argument, 0, 'g'},
+        {"wake-file",   required_argument, 0, 'f'},
+        {"early",       no_argument,       0, 'e'},
         {"verbose",     no_argument,       0, 'v'},
         {"version",     no_argument,       0, 'V'},
         {"help",        no_argument,       0, 'h'},
@@ -341,7 +493,7 @@ static void parse_args(int argc, char **argv, config_s *cfg) {
     };
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "b:t:d:l:i:vVh", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "b:t:d:s:a:l:i:w:g:f:evVh", long_options, NULL)) != -1) {
         switch (opt) {
             case 'b':
                 if (parse_int(optarg, &cfg->brightness) < 0) {
@@ -361,6 +513,18 @@ static void parse_args(int argc, char **argv, config_s *cfg) {
                     exit(EXIT_FAILURE);
                 }
                 break;
+            case 's':
+                if (parse_int(optarg, &cfg->slack_ms) < 0) {
+                    log_err("Invalid slack: %s", optarg);
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'a':
+                if (parse_int(optarg, &cfg->align_sec) < 0) {
+                    log_err("Invalid align: %s", optarg);
+                    exit(EXIT_FAILURE);
+                }
+                break;
             case 'l':
                 if (!validate_device_name(optarg)) {
                     log_err("Invalid backlight name: %s", optarg);
@@ -375,6 +539,29 @@ static void parse_args(int argc, char **argv, config_s *cfg) {
                 }
                 snprintf(cfg->device, sizeof(cfg->device), "%s", optarg);
                 break;
+            case 'w':
+                if (!validate_wake_path(optarg)) {
+                    log_err("Invalid wake socket path: %s", optarg);
+                    exit(EXIT_FAILURE);
+                }
+                snprintf(cfg->wake_socket, sizeof(cfg->wake_socket), "%s", optarg);
+                break;
+            case 'g':
+                if (parse_int(optarg, &cfg->wake_gid) < 0 || cfg->wake_gid < 0) {
+                    log_err("Invalid wake gid: %s", optarg);
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'f':
+                if (!validate_wake_path(optarg)) {
+                    log_err("Invalid wake file path: %s", optarg);
+                    exit(EXIT_FAILURE);
+                }
+                snprintf(cfg->wake_file, sizeof(cfg->wake_file), "%s", optarg);
+                break;
+            case 'e':
+                cfg->early = true;
+                break;
             case 'v':
                 g_verbose = true;
                 break;
@@ -406,6 +593,23 @@ static void parse_args(int argc, char **argv, config_s *cfg) {
                  cfg->dim_percent, MIN_DIM_PERCENT, MAX_DIM_PERCENT, DEFAULT_DIM_PERCENT);
         cfg->dim_percent = DEFAULT_DIM_PERCENT;
     }
+    if (cfg->slack_ms < MIN_SLACK_MS || cfg->slack_ms > MAX_SLACK_MS) {
+        log_warn("slack %d out of range (%d-%d), using kernel default",
+                 cfg->slack_ms, MIN_SLACK_MS, MAX_SLACK_MS);
+        cfg->slack_ms = 0;
+    }
+    if (cfg->align_sec < MIN_ALIGN_SEC || cfg->align_sec > MAX_ALIGN_SEC) {
+        log_warn("align %d out of range (%d-%d), disabling alignment",
+                 cfg->align_sec, MIN_ALIGN_SEC, MAX_ALIGN_SEC);
+        cfg->align_sec = 0;
+    }
+
+    /* No /run in initramfs, and the service instance owns these paths */
+    if (cfg->early && (cfg->wake_socket[0] != '\0' || cfg->wake_file[0] != '\0')) {
+        log_warn("wake socket/file ignored in early-boot mode");
+        cfg->wake_socket[0] = '\0';
+        cfg->wake_file[0] = '\0';
+    }
 }
 
 /* Device I/O */
@@ -477,6 +681,27 @@ static int set_brightness(int fd, int value) {
     return 0;
 }
 
+/*
+ * Read current brightness from open backlight fd (sysfs supports pread at 0).
+ * Returns brightness, or -1 on failure.
+ */
+static int get_brightness(int fd) {
+    char buf[SYSFS_VALUE_LEN];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0)
+        return -1;
+
+    buf[n] = '\0';
+    /* Trim trailing whitespace (sysfs includes newline) */
+    while (n > 0 && (buf[n-1] == '\n' || buf[n-1] == ' '))
+        buf[--n] = '\0';
+
+    int val;
+    if (parse_int(buf, &val) < 0 || val < 0)
+        return -1;
+    return val;
+}
+
 static int open_input(const char *name) {
     char path[PATH_BUFFER_LEN];
     snprintf(path, sizeof(path), "%s/%s", DEV_INPUT_PATH, name);
@@ -501,6 +726,566 @@ static bool drain_touch_events(int fd) {
     return had_touch;
 }
 
+/* External wake sources */
+
+/*
+ * Create listening Unix socket at path, replacing any stale socket file.
+ * Refuses to replace anything that is not a socket (e.g. a mistyped -w path).
+ * gid >= 0 hands the socket to that group, so its members may connect.
+ * Returns listening fd, or -1 on failure.
+ */
+static int open_wake_socket(const char *path, int gid) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            log_err("%s exists and is not a socket, refusing to replace", path);
+            return -1;
+        }
+        if (unlink(path) < 0) {
+            log_err("Cannot remove stale %s: %s", path, strerror(errno));
+            return -1;
+        }
+    } else if (errno != ENOENT) {
+        log_err("Cannot stat %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        log_err("socket failed: %s", strerror(errno));
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        chmod(path, WAKE_SOCKET_MODE) < 0 ||
+        (gid >= 0 && chown(path, (uid_t)-1, (gid_t)gid) < 0) ||
+        listen(fd, WAKE_SOCKET_BACKLOG) < 0) {
+        log_err("Cannot listen on %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Pass nfds fds (<= MAX_PASSED_FDS) to peer with a len-byte payload (SCM_RIGHTS).
+ * Returns 0 on success, -1 on failure.
+ */
+static int send_fds(int sock, const void *data, size_t len,
+                    const int *fds, size_t nfds) {
+    struct iovec iov = { .iov_base = (void *)data, .iov_len = len };
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)];
+        struct cmsghdr align;
+    } ctrl;
+    memset(&ctrl, 0, sizeof(ctrl));
+
+    struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = ctrl.buf,
+        .msg_controllen = CMSG_SPACE(sizeof(int) * nfds)
+    };
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+
+    if (sendmsg(sock, &msg, MSG_NOSIGNAL | MSG_DONTWAIT) != (ssize_t)len)
+        return -1;
+    return 0;
+}
+
+/*
+ * Receive exactly len bytes plus up to max_fds fds (<= MAX_PASSED_FDS).
+ * Unfilled fds slots are set to -1.
+ * Returns number of fds received, or -1 on failure (fds closed) with errno
+ * ECONNRESET if the peer closed, EBADMSG on short read/truncation or more
+ * than max_fds fds (CMSG_SPACE padding can fit one extra).
+ */
+static int recv_fds(int sock, void *data, size_t len, int *fds, size_t max_fds) {
+    struct iovec iov = { .iov_base = data, .iov_len = len };
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)];
+        struct cmsghdr align;
+    } ctrl;
+    memset(&ctrl, 0, sizeof(ctrl));
+
+    struct msghdr msg = {
+        .msg_iov = &iov,
+        .msg_iovlen = 1,
+        .msg_control = ctrl.buf,
+        .msg_controllen = CMSG_SPACE(sizeof(int) * max_fds)
+    };
+
+    for (size_t i = 0; i < max_fds; i++)
+        fds[i] = -1;
+
+    ssize_t n = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+
+    int count = 0;
+    bool extra = false;
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (n > 0 && cmsg && cmsg->cmsg_level == SOL_SOCKET &&
+        cmsg->cmsg_type == SCM_RIGHTS) {
+        size_t got = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < got; i++) {
+            int fd;
+            memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            if (i < max_fds) {
+                fds[i] = fd;
+                count++;
+            } else {
+                close(fd);
+                extra = true;
+            }
+        }
+    }
+
+    if (n != (ssize_t)len || extra ||
+        (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+        int err = (n < 0) ? errno : (n == 0) ? ECONNRESET : EBADMSG;
+        for (int i = 0; i < count; i++) {
+            close(fds[i]);
+            fds[i] = -1;
+        }
+        errno = err;
+        return -1;
+    }
+    return count;
+}
+
+static void drop_wake_client(wake_s *ws, int slot) {
+    if (ws->client_fds[slot] >= 0) {
+        close(ws->client_fds[slot]);
+        ws->client_fds[slot] = -1;
+    }
+}
+
+/*
+ * Store our end of a client's socketpair in a free slot, evicting the oldest
+ * client (lowest connect sequence number) when all slots are in use.
+ */
+static void add_wake_client(wake_s *ws, int read_fd) {
+    int slot = -1;
+    for (int i = 0; i < WAKE_CLIENT_SLOTS && slot < 0; i++) {
+        if (ws->client_fds[i] < 0)
+            slot = i;
+    }
+    if (slot < 0) {
+        slot = 0;
+        for (int i = 1; i < WAKE_CLIENT_SLOTS; i++) {
+            if (ws->client_seq[i] < ws->client_seq[slot])
+                slot = i;
+        }
+        log_verbose("Wake client slots full, evicting slot %d", slot);
+        drop_wake_client(ws, slot);
+    }
+    ws->client_fds[slot] = read_fd;
+    ws->client_seq[slot] = ws->next_seq++;
+}
+
+/*
+ * Accept all pending clients, hand each one end of its own wake socketpair,
+ * then hang up. The daemon keeps only the non-blocking other end.
+ */
+static void serve_wake_clients(wake_s *ws) {
+    for (;;) {
+        int client = accept4(ws->socket_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                log_warn("accept failed: %s", strerror(errno));
+            return;
+        }
+
+        /* SOCK_SEQPACKET: client writes never raise SIGPIPE, and its close
+         * shows up as POLLHUP on our end (SOCK_DGRAM would not) */
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                       0, pair) < 0) {
+            log_warn("socketpair failed: %s", strerror(errno));
+            close(client);
+            continue;
+        }
+        if (send_fds(client, "W", 1, &pair[1], 1) < 0) {
+            log_warn("Cannot send wake fd: %s", strerror(errno));
+            close(pair[0]);
+        } else {
+            add_wake_client(ws, pair[0]);
+            log_verbose("Wake fd handed to client");
+        }
+        close(pair[1]);
+        close(client);
+    }
+}
+
+/* Drain a non-blocking wake fd. Returns true if any wake was pending. */
+static bool drain_wake_fd(int fd) {
+    char buf[WAKE_DRAIN_LEN];
+    bool woke = false;
+    while (read(fd, buf, sizeof(buf)) > 0)
+        woke = true;
+    return woke;
+}
+
+/*
+ * Split wake file path into directory to watch and trigger name.
+ * An existing directory is watched as-is with an empty name (any entry wakes).
+ * Otherwise the parent directory is watched, filtered on the last component.
+ * Caller ensures path passed validate_wake_path(). dir and name are WAKE_PATH_LEN.
+ */
+static void split_wake_path(const char *path, char *dir, char *name) {
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+        snprintf(dir, WAKE_PATH_LEN, "%s", path);
+        name[0] = '\0';
+        return;
+    }
+
+    const char *slash = strrchr(path, '/');
+    size_t dir_len = (slash == path) ? 1 : (size_t)(slash - path);
+    memcpy(dir, path, dir_len);
+    dir[dir_len] = '\0';
+    snprintf(name, WAKE_PATH_LEN, "%s", slash + 1);
+}
+
+/*
+ * Create trigger file (or reuse an existing regular file) with WAKE_FILE_MODE,
+ * so clients in group gid (>= 0) can `touch` it without write access to the
+ * directory. Returns 0 on success, -1 on failure (symlink, FIFO, etc. are refused).
+ */
+static int create_wake_file(const char *path, int gid) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_NOFOLLOW | O_NONBLOCK | O_CLOEXEC,
+                  WAKE_FILE_MODE);
+    if (fd < 0) {
+        log_warn("Cannot create wake file %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    int ret = 0;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        log_warn("Wake file %s is not a regular file", path);
+        ret = -1;
+    } else if (fchmod(fd, WAKE_FILE_MODE) < 0 ||  /* Override umask */
+               (gid >= 0 && fchown(fd, (uid_t)-1, (gid_t)gid) < 0)) {
+        log_warn("Cannot set wake file %s permissions: %s", path, strerror(errno));
+        ret = -1;
+    }
+    close(fd);
+    return ret;
+}
+
+/* True if inotify event on the watched directory is a wake for name */
+static bool wake_event_matches(const struct inotify_event *ev, const char *name) {
+    if (!(ev->mask & WAKE_FILE_MASK))
+        return false;
+    if (name[0] == '\0')
+        return true;
+    return ev->len > 0 && strcmp(ev->name, name) == 0;
+}
+
+/*
+ * Drain pending inotify events. Returns true if any matched the trigger.
+ * Watch removal (directory deleted or unmounted) disables the wake file;
+ * the fd then never becomes readable again, so it costs nothing in poll().
+ */
+static bool drain_wake_inotify(int fd, const char *name) {
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool woke = false;
+    ssize_t n;
+
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + n; ) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            if (ev->mask & IN_Q_OVERFLOW)
+                woke = true;
+            else if (ev->mask & IN_IGNORED)
+                log_warn("Wake file directory removed, file wake disabled");
+            else if (wake_event_matches(ev, name))
+                woke = true;
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+
+    return woke;
+}
+
+static void close_wake_sources(const config_s *cfg, wake_s *ws) {
+    if (ws->socket_fd >= 0) {
+        close(ws->socket_fd);
+        unlink(cfg->wake_socket);
+        ws->socket_fd = -1;
+    }
+    for (int i = 0; i < WAKE_CLIENT_SLOTS; i++)
+        drop_wake_client(ws, i);
+    if (ws->inotify_fd >= 0) {
+        close(ws->inotify_fd);
+        ws->inotify_fd = -1;
+    }
+}
+
+/*
+ * Open optional wake sources configured in cfg.
+ * Returns 0 on success (including when none configured), -1 on failure.
+ */
+static int open_wake_sources(const config_s *cfg, wake_s *ws) {
+    ws->socket_fd = -1;
+    for (int i = 0; i < WAKE_CLIENT_SLOTS; i++) {
+        ws->client_fds[i] = -1;
+        ws->client_seq[i] = 0;
+    }
+    ws->next_seq = 0;
+    ws->inotify_fd = -1;
+    ws->watch_name[0] = '\0';
+
+    if (cfg->wake_socket[0] != '\0') {
+        ws->socket_fd = open_wake_socket(cfg->wake_socket, cfg->wake_gid);
+        if (ws->socket_fd < 0)
+            return -1;
+
+        log_info("Wake socket: %s", cfg->wake_socket);
+    }
+
+    /* Opened after the socket and trigger file so their chmod() is not seen as a wake */
+    if (cfg->wake_file[0] != '\0') {
+        char dir[WAKE_PATH_LEN];
+        split_wake_path(cfg->wake_file, dir, ws->watch_name);
+
+        /* Not fatal: root clients can still create the file themselves */
+        if (ws->watch_name[0] != '\0')
+            create_wake_file(cfg->wake_file, cfg->wake_gid);
+
+        ws->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (ws->inotify_fd < 0) {
+            log_err("inotify_init1 failed: %s", strerror(errno));
+            close_wake_sources(cfg, ws);
+            return -1;
+        }
+        if (inotify_add_watch(ws->inotify_fd, dir, WAKE_FILE_MASK | IN_ONLYDIR) < 0) {
+            log_err("Cannot watch %s: %s", dir, strerror(errno));
+            close_wake_sources(cfg, ws);
+            return -1;
+        }
+
+        log_info("Wake file: %s", cfg->wake_file);
+    }
+
+    return 0;
+}
+
+/* Early-boot handoff */
+
+/* Fill abstract socket address (leading NUL, no filesystem entry) */
+static socklen_t handoff_addr(struct sockaddr_un *addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    memcpy(addr->sun_path + 1, HANDOFF_SOCKET_NAME, sizeof(HANDOFF_SOCKET_NAME) - 1);
+    return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + sizeof(HANDOFF_SOCKET_NAME));
+}
+
+/*
+ * Validate handoff message from early instance.
+ * Forces NUL termination of device names before checking them.
+ */
+static bool validate_handoff(handoff_s *ho) {
+    ho->backlight[sizeof(ho->backlight) - 1] = '\0';
+    ho->device[sizeof(ho->device) - 1] = '\0';
+
+    return ho->magic == HANDOFF_MAGIC &&
+           ho->state <= STATE_OFF &&
+           ho->brightness >= 0 && ho->brightness <= MAX_BRIGHTNESS &&
+           validate_device_name(ho->backlight) &&
+           validate_device_name(ho->device);
+}
+
+/*
+ * Check handed-over fds are the kind we would open ourselves:
+ * backlight is a sysfs attribute (regular file), input is a char device.
+ */
+static bool validate_handoff_fds(const int fds[MAX_PASSED_FDS]) {
+    struct stat st;
+    if (fds[0] < 0 || fstat(fds[0], &st) < 0 || !S_ISREG(st.st_mode))
+        return false;
+    if (fds[1] < 0 || fstat(fds[1], &st) < 0 || !S_ISCHR(st.st_mode))
+        return false;
+    return true;
+}
+
+/*
+ * Mark early instance as a root storage daemon (argv[0][0] = '@'), the
+ * systemd convention for processes it must not kill when leaving initrd.
+ */
+static void mark_early_process(char **argv) {
+    if (argv[0] && argv[0][0] != '\0')
+        argv[0][0] = '@';
+}
+
+/*
+ * Early instance: listen on abstract handoff socket.
+ * Returns listening fd, or -1 on failure (e.g. early instance already running).
+ */
+static int open_handoff_socket(void) {
+    struct sockaddr_un addr;
+    socklen_t addr_len = handoff_addr(&addr);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        log_err("socket failed: %s", strerror(errno));
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, addr_len) < 0 || listen(fd, 1) < 0) {
+        log_err("Cannot listen on handoff socket: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Early instance: accept service instance and send state plus device fds.
+ * Only peers with our uid (or root) may take over the backlight fd.
+ * Returns true once such a peer has connected: the caller must exit even if
+ * the send failed, so the service instance never runs alongside us.
+ */
+static bool serve_handoff(int listen_fd, const handoff_s *ho, int bl_fd, int input_fd) {
+    int client = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (client < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            log_warn("accept failed: %s", strerror(errno));
+        return false;
+    }
+
+    struct ucred cred;
+    socklen_t cred_len = sizeof(cred);
+    if (getsockopt(client, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) < 0 ||
+        (cred.uid != 0 && cred.uid != getuid())) {
+        log_warn("Handoff refused for unprivileged peer");
+        close(client);
+        return false;
+    }
+
+    int fds[MAX_PASSED_FDS] = { bl_fd, input_fd };
+    if (send_fds(client, ho, sizeof(*ho), fds, MAX_PASSED_FDS) < 0)
+        log_warn("Handoff send failed (%s), exiting and leaving panel as is",
+                 strerror(errno));
+    close(client);
+    return true;
+}
+
+/*
+ * Service instance: connect to the early instance's handoff socket.
+ * Returns connected socket, or -1 with *retry set if an early instance may
+ * still be listening (busy backlog, interrupted) and the caller should retry.
+ */
+static int connect_handoff(bool *retry) {
+    struct sockaddr_un addr;
+    socklen_t addr_len = handoff_addr(&addr);
+
+    *retry = false;
+    int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (sock < 0)
+        return -1;
+
+    /* Bound waits (connect to a full backlog, recv) in case the listener is stuck */
+    struct timeval tv = { .tv_sec = HANDOFF_TIMEOUT_SEC };
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    if (connect(sock, (struct sockaddr *)&addr, addr_len) < 0) {
+        *retry = (errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT);
+        if (!*retry)
+            log_verbose("No early-boot instance to take over (%s)", strerror(errno));
+        close(sock);
+        return -1;
+    }
+
+    struct ucred cred;
+    socklen_t cred_len = sizeof(cred);
+    if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) < 0 ||
+        cred.uid != 0) {
+        log_warn("Handoff socket not owned by root, ignoring");
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+static void sleep_ms(long ms) {
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L };
+    while (nanosleep(&ts, &ts) < 0 && errno == EINTR)
+        ;
+}
+
+/*
+ * Service instance: take over from a running early instance, if any.
+ * Abstract names have no permissions, so the listener must be root and
+ * the fds must look like our own devices before anything is trusted.
+ * On success fills ho and fds (backlight, input) and returns true.
+ */
+static bool take_over_early(handoff_s *ho, int fds[MAX_PASSED_FDS]) {
+    fds[0] = fds[1] = -1;
+
+    /*
+     * Starting fresh while an early instance still listens would leave two
+     * daemons driving the panel. Keep waiting on a connected peer across recv
+     * timeouts, and reconnect if it hung up without a handoff: it exits after
+     * any failed send, so the next connect is refused and we start fresh.
+     */
+    uint32_t deadline = now_sec() + HANDOFF_MAX_WAIT_SEC;
+    int count = -1;
+    for (;;) {
+        bool retry;
+        int sock = connect_handoff(&retry);
+        if (sock >= 0) {
+            do {
+                count = recv_fds(sock, ho, sizeof(*ho), fds, MAX_PASSED_FDS);
+            } while (count < 0 && (errno == EAGAIN || errno == EINTR) &&
+                     now_sec() < deadline);
+            retry = (count < 0 && errno != EBADMSG);
+            close(sock);
+            if (!retry)
+                break;
+        }
+        if (!retry)
+            return false;
+        if (now_sec() >= deadline) {
+            log_warn("Early-boot instance did not hand off within %ds, starting fresh",
+                     HANDOFF_MAX_WAIT_SEC);
+            return false;
+        }
+        sleep_ms(HANDOFF_RETRY_MS);
+    }
+
+    if (count != MAX_PASSED_FDS || !validate_handoff(ho) ||
+        !validate_handoff_fds(fds)) {
+        log_warn("Invalid handoff from early-boot instance, starting fresh");
+        for (int i = 0; i < MAX_PASSED_FDS; i++) {
+            if (fds[i] >= 0)
+                close(fds[i]);
+            fds[i] = -1;
+        }
+        return false;
+    }
+    return true;
+}
+
+/* Use handed-over fd if it refers to the configured device, else close it */
+static int adopt_fd(int handed_fd, bool same_device) {
+    if (handed_fd >= 0 && !same_device) {
+        close(handed_fd);
+        return -1;
+    }
+    return handed_fd;
+}
+
 /* Signal handling */
 
 static void handle_signal(int sig) {
@@ -540,11 +1325,38 @@ int main(int argc, char *argv[]) {
         .brightness = DEFAULT_BRIGHTNESS,
         .timeout_sec = DEFAULT_TIMEOUT_SEC,
         .dim_percent = DEFAULT_DIM_PERCENT,
+        .slack_ms = 0,
+        .align_sec = 0,
         .backlight = "",
-        .device = ""
+        .device = "",
+        .wake_socket = "",
+        .wake_file = "",
+        .wake_gid = -1,
+        .early = false
     };
     parse_args(argc, argv, &cfg);
 
+    /* Early instance: claim the handoff socket before touching the panel,
+     * so a second early instance exits without overwriting its brightness */
+    int handoff_fd = -1;
+    if (cfg.early) {
+        mark_early_process(argv);
+        handoff_fd = open_handoff_socket();
+        if (handoff_fd < 0)
+            return EXIT_FAILURE;
+    }
+
+    /* Take over from early-boot instance, if one is running */
+    handoff_s ho = {0};
+    int ho_fds[MAX_PASSED_FDS] = { -1, -1 };
+    bool took_over = !cfg.early && take_over_early(&ho, ho_fds);
+    if (took_over) {
+        if (cfg.backlight[0] == '\0')
+            snprintf(cfg.backlight, sizeof(cfg.backlight), "%s", ho.backlight);
+        if (cfg.device[0] == '\0')
+            snprintf(cfg.device, sizeof(cfg.device), "%s", ho.device);
+    }
+
     /* Auto-detect devices if not specified by user */
     if (cfg.backlight[0] == '\0') {
         if (find_backlight_device(cfg.backlight, sizeof(cfg.backlight))) {
@@ -564,12 +1376,17 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    /* Open devices */
-    int bl_fd = open_backlight(cfg.backlight);
+    /* Open devices, reusing early instance's fds (keeps queued touches) */
+    bool restore = took_over && strcmp(cfg.backlight, ho.backlight) == 0;
+    int bl_fd = adopt_fd(ho_fds[0], restore);
     if (bl_fd < 0)
-        return EXIT_FAILURE;
+        bl_fd = open_backlight(cfg.backlight);
+    if (bl_fd < 0)
+        goto cleanup_handoff;
 
-    int input_fd = open_input(cfg.device);
+    int input_fd = adopt_fd(ho_fds[1], took_over && strcmp(cfg.device, ho.device) == 0);
+    if (input_fd < 0)
+        input_fd = open_input(cfg.device);
     if (input_fd < 0)
         goto cleanup_bl;
 
@@ -590,35 +1407,76 @@ int main(int argc, char *argv[]) {
     /* Initialize state machine */
     state_s state;
     state_init(&state, cfg.brightness, dim_bright, dim_sec, off_sec);
-    state_touch(&state, now_sec());
 
-    /* Set initial brightness */
-    if (set_brightness(bl_fd, cfg.brightness) < 0) {
-        log_err("Cannot set initial brightness - check permissions");
-        goto cleanup_all;
+    /* Set initial brightness (after handoff: only if our config differs) */
+    int cached_brightness;
+    if (restore) {
+        int target = state_restore(&state, (state_e)ho.state, ho.last_touch_sec);
+        /* Panel may have changed since the early instance's last write
+         * (e.g. systemd-backlight restore), so compare against sysfs */
+        cached_brightness = get_brightness(bl_fd);
+        if (cached_brightness < 0)
+            cached_brightness = ho.brightness;
+        log_info("Took over from early-boot instance (brightness %d)", cached_brightness);
+        if (target != cached_brightness && set_brightness(bl_fd, target) == 0)
+            cached_brightness = target;
+    } else {
+        state_touch(&state, now_sec());
+        if (set_brightness(bl_fd, cfg.brightness) < 0) {
+            log_err("Cannot set initial brightness - check permissions");
+            goto cleanup_all;
+        }
+        cached_brightness = cfg.brightness;
     }
 
     /* Register signal handlers */
     if (setup_signals() < 0)
         goto cleanup_all;
 
+    /* Let the kernel batch our timer expiry with other wakeups */
+    if (cfg.slack_ms > 0 &&
+        prctl(PR_SET_TIMERSLACK, (unsigned long)cfg.slack_ms * 1000000UL) < 0)
+        log_warn("PR_SET_TIMERSLACK failed: %s", strerror(errno));
+
+    /* Open optional external wake sources */
+    wake_s wake;
+    if (open_wake_sources(&cfg, &wake) < 0)
+        goto cleanup_all;
+
+    if (cfg.early)
+        log_info("Early-boot mode, waiting for service instance");
+
     /* Daemon ready */
     sd_notify(0, "READY=1");
     log_info("touch-timeout v%s: brightness=%d, dim=%d, dim=%u:%02u, off=%u:%02u",
              VERSION_STRING, cfg.brightness, dim_bright,
              dim_sec / 60, dim_sec % 60,
              off_sec / 60, off_sec % 60);
+    if (cfg.slack_ms > 0 || cfg.align_sec > 0)
+        log_info("Timer tolerance: slack=%dms, align=%ds", cfg.slack_ms, cfg.align_sec);
 
     /* Event loop - block on input, wake on touch or timeout */
-    int cached_brightness = cfg.brightness;
-    struct pollfd pfd = { .fd = input_fd, .events = POLLIN };
+    bool handed_off = false;
+    /* Disabled sources have fd = -1, which poll() ignores */
+    enum { PFD_INPUT, PFD_WAKE_SOCKET, PFD_WAKE_FILE, PFD_HANDOFF,
+           PFD_WAKE_CLIENT, PFD_COUNT = PFD_WAKE_CLIENT + WAKE_CLIENT_SLOTS };
+    struct pollfd pfds[PFD_COUNT] = {
+        [PFD_INPUT]       = { .fd = input_fd,       .events = POLLIN },
+        [PFD_WAKE_SOCKET] = { .fd = wake.socket_fd, .events = POLLIN },
+        [PFD_WAKE_FILE]   = { .fd = wake.inotify_fd, .events = POLLIN },
+        [PFD_HANDOFF]     = { .fd = handoff_fd,     .events = POLLIN }
+    };
+    for (int i = 0; i < WAKE_CLIENT_SLOTS; i++)
+        pfds[PFD_WAKE_CLIENT + i] = (struct pollfd){ .fd = -1, .events = POLLIN };
 
     while (g_running) {
         uint32_t now = now_sec();
         int timeout_sec = state_get_timeout_sec(&state, now);
         int timeout_ms = (timeout_sec < 0) ? -1 : timeout_sec * 1000;
+        if (cfg.align_sec > 0)
+            timeout_ms = align_timeout_ms(now_ms(), timeout_ms, (uint32_t)cfg.align_sec * 1000U);
 
-        int ret = poll(&pfd, 1, timeout_ms);
+        int ret = poll(pfds, PFD_COUNT, timeout_ms);
 
         if (ret < 0) {
             if (errno == EINTR) {
@@ -643,12 +1501,37 @@ int main(int argc, char *argv[]) {
         now = now_sec();
         int new_bright = STATE_NO_CHANGE;
 
-        if (ret > 0 && (pfd.revents & POLLIN)) {
+        if (ret > 0) {
+            const char *wake_source = NULL;
+
             /* Touch event - wake display */
-            if (drain_touch_events(input_fd)) {
+            if ((pfds[PFD_INPUT].revents & POLLIN) && drain_touch_events(input_fd))
+                wake_source = "Touch";
+
+            /* External wake via client fds - pending writes collapse into one drain */
+            for (int i = 0; i < WAKE_CLIENT_SLOTS; i++) {
+                short rev = pfds[PFD_WAKE_CLIENT + i].revents;
+                if ((rev & POLLIN) && drain_wake_fd(wake.client_fds[i]) && !wake_source)
+                    wake_source = "Wake client";
+                if (rev & (POLLHUP | POLLERR))
+                    drop_wake_client(&wake, i);  /* Client closed its end */
+            }
+
+            /* External wake via trigger file */
+            if ((pfds[PFD_WAKE_FILE].revents & POLLIN) &&
+                drain_wake_inotify(wake.inotify_fd, wake.watch_name) && !wake_source)
+                wake_source = "Wake file";
+
+            /* New wake socket client - hand out wake fd */
+            if (pfds[PFD_WAKE_SOCKET].revents & POLLIN)
+                serve_wake_clients(&wake);
+            for (int i = 0; i < WAKE_CLIENT_SLOTS; i++)
+                pfds[PFD_WAKE_CLIENT + i].fd = wake.client_fds[i];
+
+            if (wake_source) {
                 new_bright = state_touch(&state, now);
                 if (new_bright >= 0)
-                    log_verbose("Touch -> FULL (brightness %d)", new_bright);
+                    log_verbose("%s -> FULL (brightness %d)", wake_source, new_bright);
             }
         } else if (ret == 0) {
             /* Timeout - advance state machine */
@@ -664,15 +1547,36 @@ int main(int argc, char *argv[]) {
             if (set_brightness(bl_fd, new_bright) == 0)
                 cached_brightness = new_bright;
         }
+
+        /* Service instance taking over - hand off after brightness is applied */
+        if (ret > 0 && (pfds[PFD_HANDOFF].revents & POLLIN)) {
+            handoff_s out = {
+                .magic = HANDOFF_MAGIC,
+                .state = (uint32_t)state_get_current(&state),
+                .last_touch_sec = state_get_last_touch(&state),
+                .brightness = cached_brightness
+            };
+            snprintf(out.backlight, sizeof(out.backlight), "%s", cfg.backlight);
+            snprintf(out.device, sizeof(out.device), "%s", cfg.device);
+            if (serve_handoff(handoff_fd, &out, bl_fd, input_fd)) {
+                handed_off = true;
+                break;
+            }
+        }
     }
 
-    /* Graceful shutdown - restore full brightness */
-    if (set_brightness(bl_fd, cfg.brightness) == 0) {
+    /* Graceful shutdown - restore full brightness (handoff: leave panel as is) */
+    if (handed_off) {
+        log_info("Exiting for service instance, leaving brightness at %d", cached_brightness);
+    } else if (set_brightness(bl_fd, cfg.brightness) == 0) {
         log_info("Brightness restored to %d, shutting down", cfg.brightness);
     } else {
         log_warn("Could not restore brightness on shutdown");
     }
     sd_notify(0, "STOPPING=1");
+    if (handoff_fd >= 0)
+        close(handoff_fd);
+    close_wake_sources(&cfg, &wake);
     close(input_fd);
     close(bl_fd);
     return EXIT_SUCCESS;
@@ -681,6 +1585,9 @@ cleanup_all:
     close(input_fd);
 cleanup_bl:
     close(bl_fd);
+cleanup_handoff:
+    if (handoff_fd >= 0)
+        close(handoff_fd);
     return EXIT_FAILURE;
 }
 #endif /* UNIT_TEST */
@@ -74,6 +74,21 @@ int state_timeout(state_s *st, uint32_t now_sec) {
     return STATE_NO_CHANGE;
 }
 
+int state_restore(state_s *st, state_e state, uint32_t last_touch_sec) {
+    switch (state) {
+        case STATE_FULL:
+        case STATE_DIMMED:
+        case STATE_OFF:
+            st->state = state;
+            break;
+        default:
+            st->state = STATE_FULL;  /* Invalid state */
+            break;
+    }
+    st->last_touch_sec = last_touch_sec;
+    return state_get_brightness(st);
+}
+
 int state_get_timeout_sec(const state_s *st, uint32_t now_sec) {
     /* Unsigned subtraction handles wraparound correctly */
     uint32_t idle = now_sec - st->last_touch_sec;
@@ -113,3 +128,7 @@ int state_get_brightness(const state_s *st) {
 state_e state_get_current(const state_s *st) {
     return st->state;
 }
+
+uint32_t state_get_last_touch(const state_s *st) {
+    return st->last_touch_sec;
+}
@@ -12,6 +12,8 @@
  *   3. In event loop: use state_get_timeout_sec() for poll(),
  *      state_touch() on events, state_timeout() on expiry
  *   4. Functions return new brightness or STATE_NO_CHANGE (-1)
+ *   (Handoff: state_restore() replaces step 2 when taking over from
+ *    an early-boot instance)
  *
  * IMPLEMENTATION:
  *   - state.c - Pure state machine (no I/O, fully testable)
@@ -81,6 +83,17 @@ int state_touch(state_s *st, uint32_t now_sec);
  */
 int state_timeout(state_s *st, uint32_t now_sec);
 
+/*
+ * Restore state handed over from another instance
+ *
+ * Sets state and last_touch_sec directly, without a transition
+ * (early-boot handoff). Invalid state values fall back to STATE_FULL.
+ * Timestamps are CLOCK_MONOTONIC, which is shared system-wide.
+ *
+ * Returns: brightness value for the restored state
+ */
+int state_restore(state_s *st, state_e state, uint32_t last_touch_sec);
+
 /*
  * Get seconds until next transition
  *
@@ -103,4 +116,11 @@ int state_get_brightness(const state_s *st);
  */
 state_e state_get_current(const state_s *st);
 
+/*
+ * Get timestamp of last touch
+ *
+ * Returns: last_touch_sec (monotonic sec), e.g. for early-boot handoff
+ */
+uint32_t state_get_last_touch(const state_s *st);
+
 #endif /* TOUCH_TIMEOUT_STATE_H */
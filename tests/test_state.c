@@ -11,6 +11,10 @@
  *   - Timeout calculations and wraparound handling
  *   - Brightness calculations and clamping
  *   - Input parsing and validation (boundary cases, security)
+ *   - Per-client wake fds over a real Unix socket (SCM_RIGHTS, slot eviction)
+ *   - Wake file path splitting and inotify event filtering
+ *   - Deadline alignment for timer tolerance
+ *   - Early-boot handoff: state restore, message validation, fd passing
  *   - Edge cases: zero timeouts, wraparound, extreme values
  *
  * RUNNING TESTS:
@@ -26,6 +30,7 @@
 #include "../src/main.c"
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/eventfd.h>
 
 /* Test framework */
 static int tests_run = 0;
@@ -508,6 +513,652 @@ TEST(test_validate_device_name_accepts_max_minus_one) {
     ASSERT_TRUE(validate_device_name(ok_name));
 }
 
+/* ==================== WAKE SOURCE TESTS ==================== */
+
+TEST(test_validate_wake_path_valid) {
+    ASSERT_TRUE(validate_wake_path("/run/touch-timeout/wake.sock"));
+    ASSERT_TRUE(validate_wake_path("/tmp/w"));
+}
+
+TEST(test_validate_wake_path_rejects_relative) {
+    ASSERT_TRUE(!validate_wake_path("wake.sock"));
+    ASSERT_TRUE(!validate_wake_path(""));
+    ASSERT_TRUE(!validate_wake_path("/"));
+}
+
+TEST(test_validate_wake_path_rejects_dotdot) {
+    ASSERT_TRUE(!validate_wake_path("/run/../etc/wake.sock"));
+}
+
+TEST(test_validate_wake_path_rejects_too_long) {
+    /* WAKE_PATH_LEN includes null terminator */
+    char path[WAKE_PATH_LEN + 1];
+    memset(path, 'a', WAKE_PATH_LEN);
+    path[0] = '/';
+    path[WAKE_PATH_LEN] = '\0';
+    ASSERT_TRUE(!validate_wake_path(path));
+    path[WAKE_PATH_LEN - 1] = '\0';
+    ASSERT_TRUE(validate_wake_path(path));
+}
+
+TEST(test_wake_socket_refuses_non_socket) {
+    /* Mistyped -w path must not delete an existing regular file */
+    char path[] = "/tmp/test_wake_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_TRUE(fd >= 0);
+    close(fd);
+
+    ASSERT_EQ(open_wake_socket(path, -1), -1);
+    ASSERT_EQ(access(path, F_OK), 0);
+    unlink(path);
+}
+
+TEST(test_wake_socket_replaces_stale_socket) {
+    char path[] = "/tmp/test_wake_XXXXXX";
+    int tmp = mkstemp(path);
+    ASSERT_TRUE(tmp >= 0);
+    close(tmp);
+    unlink(path);
+
+    int first = open_wake_socket(path, -1);
+    ASSERT_TRUE(first >= 0);
+    close(first);  /* Socket file left behind, as after a crash */
+
+    int second = open_wake_socket(path, -1);
+    ASSERT_TRUE(second >= 0);
+    close(second);
+    unlink(path);
+}
+
+/* Listening wake socket on an autobound abstract address, for connect_wake_client() */
+static int open_test_wake_listener(struct sockaddr_un *addr, socklen_t *len) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    struct sockaddr_un any = { .sun_family = AF_UNIX };
+    if (fd < 0 || bind(fd, (struct sockaddr *)&any, sizeof(sa_family_t)) < 0 ||
+        listen(fd, WAKE_CLIENT_SLOTS + 1) < 0)
+        return -1;
+    *len = sizeof(*addr);
+    getsockname(fd, (struct sockaddr *)addr, len);
+    return fd;
+}
+
+static int connect_wake_client(const struct sockaddr_un *addr, socklen_t len) {
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0 || connect(sock, (const struct sockaddr *)addr, len) < 0)
+        return -1;
+    return sock;
+}
+
+static int recv_wake_fd(int sock) {
+    char byte;
+    int fd;
+    int n = recv_fds(sock, &byte, 1, &fd, 1);
+    close(sock);
+    return (n == 1) ? fd : -1;
+}
+
+TEST(test_wake_client_own_fd) {
+    wake_s ws;
+    config_s cfg = { .wake_socket = "", .wake_file = "", .wake_gid = -1 };
+    ASSERT_EQ(open_wake_sources(&cfg, &ws), 0);
+    struct sockaddr_un addr;
+    socklen_t len;
+    ws.socket_fd = open_test_wake_listener(&addr, &len);
+    ASSERT_TRUE(ws.socket_fd >= 0);
+
+    int a = connect_wake_client(&addr, len);
+    int b = connect_wake_client(&addr, len);
+    ASSERT_TRUE(a >= 0 && b >= 0);
+    serve_wake_clients(&ws);
+    int fd_a = recv_wake_fd(a);
+    int fd_b = recv_wake_fd(b);
+    ASSERT_TRUE(fd_a >= 0 && fd_b >= 0);
+    ASSERT_TRUE(ws.client_fds[0] >= 0 && ws.client_fds[1] >= 0);
+
+    /* No wake pending yet */
+    ASSERT_TRUE(!drain_wake_fd(ws.client_fds[0]));
+
+    /* Client clearing O_NONBLOCK on its end cannot make our drain block */
+    ASSERT_EQ(fcntl(fd_a, F_SETFL, 0), 0);
+    ASSERT_TRUE(!drain_wake_fd(ws.client_fds[0]));
+
+    /* Two writes collapse into one drain, and only wake the writer's slot */
+    uint64_t one = 1;
+    ASSERT_EQ(write(fd_b, &one, sizeof(one)), (ssize_t)sizeof(one));
+    ASSERT_EQ(write(fd_b, &one, sizeof(one)), (ssize_t)sizeof(one));
+    ASSERT_TRUE(!drain_wake_fd(ws.client_fds[0]));
+    ASSERT_TRUE(drain_wake_fd(ws.client_fds[1]));
+    ASSERT_TRUE(!drain_wake_fd(ws.client_fds[1]));
+
+    close(fd_a);
+    close(fd_b);
+    close_wake_sources(&cfg, &ws);
+}
+
+TEST(test_wake_client_full_queue_is_one_wake) {
+    /* Writes queue as separate messages until EAGAIN; one drain clears them all */
+    wake_s ws;
+    config_s cfg = { .wake_socket = "", .wake_file = "", .wake_gid = -1 };
+    ASSERT_EQ(open_wake_sources(&cfg, &ws), 0);
+    struct sockaddr_un addr;
+    socklen_t len;
+    ws.socket_fd = open_test_wake_listener(&addr, &len);
+    ASSERT_TRUE(ws.socket_fd >= 0);
+
+    int sock = connect_wake_client(&addr, len);
+    ASSERT_TRUE(sock >= 0);
+    serve_wake_clients(&ws);
+    int fd = recv_wake_fd(sock);
+    ASSERT_TRUE(fd >= 0);
+
+    uint64_t one = 1;
+    int queued = 0;
+    while (write(fd, &one, sizeof(one)) == (ssize_t)sizeof(one))
+        queued++;
+    ASSERT_EQ(errno, EAGAIN);
+    ASSERT_TRUE(queued > 1);
+
+    /* Whole backlog is one wake, and the client can write again */
+    ASSERT_TRUE(drain_wake_fd(ws.client_fds[0]));
+    ASSERT_TRUE(!drain_wake_fd(ws.client_fds[0]));
+    ASSERT_EQ(write(fd, &one, sizeof(one)), (ssize_t)sizeof(one));
+
+    close(fd);
+    close_wake_sources(&cfg, &ws);
+}
+
+TEST(test_wake_client_hangup_frees_slot) {
+    wake_s ws;
+    config_s cfg = { .wake_socket = "", .wake_file = "", .wake_gid = -1 };
+    ASSERT_EQ(open_wake_sources(&cfg, &ws), 0);
+    struct sockaddr_un addr;
+    socklen_t len;
+    ws.socket_fd = open_test_wake_listener(&addr, &len);
+    ASSERT_TRUE(ws.socket_fd >= 0);
+
+    int sock = connect_wake_client(&addr, len);
+    ASSERT_TRUE(sock >= 0);
+    serve_wake_clients(&ws);
+    int fd = recv_wake_fd(sock);
+    ASSERT_TRUE(fd >= 0);
+
+    /* Client dropping its end shows up as POLLHUP on its slot */
+    close(fd);
+    struct pollfd pfd = { .fd = ws.client_fds[0], .events = POLLIN };
+    ASSERT_EQ(poll(&pfd, 1, 0), 1);
+    ASSERT_TRUE(pfd.revents & POLLHUP);
+    drop_wake_client(&ws, 0);
+    ASSERT_EQ(ws.client_fds[0], -1);
+
+    /* Freed slot is reused before any eviction */
+    sock = connect_wake_client(&addr, len);
+    ASSERT_TRUE(sock >= 0);
+    serve_wake_clients(&ws);
+    fd = recv_wake_fd(sock);
+    ASSERT_TRUE(fd >= 0 && ws.client_fds[0] >= 0);
+    ASSERT_EQ(ws.client_seq[0], 1);
+
+    close(fd);
+    close_wake_sources(&cfg, &ws);
+}
+
+TEST(test_wake_client_slots_evict_oldest) {
+    wake_s ws;
+    config_s cfg = { .wake_socket = "", .wake_file = "", .wake_gid = -1 };
+    ASSERT_EQ(open_wake_sources(&cfg, &ws), 0);
+    struct sockaddr_un addr;
+    socklen_t len;
+    ws.socket_fd = open_test_wake_listener(&addr, &len);
+    ASSERT_TRUE(ws.socket_fd >= 0);
+
+    int fds[WAKE_CLIENT_SLOTS + 1];
+    for (int i = 0; i <= WAKE_CLIENT_SLOTS; i++) {
+        int sock = connect_wake_client(&addr, len);
+        ASSERT_TRUE(sock >= 0);
+        serve_wake_clients(&ws);
+        fds[i] = recv_wake_fd(sock);
+        ASSERT_TRUE(fds[i] >= 0);
+    }
+
+    /* First client lost its slot to the last one: EPIPE, without SIGPIPE */
+    uint64_t one = 1;
+    ASSERT_EQ(write(fds[0], &one, sizeof(one)), -1);
+    ASSERT_EQ(errno, EPIPE);
+    ASSERT_EQ(write(fds[WAKE_CLIENT_SLOTS], &one, sizeof(one)), (ssize_t)sizeof(one));
+    ASSERT_TRUE(drain_wake_fd(ws.client_fds[0]));
+    ASSERT_EQ(ws.client_seq[0], WAKE_CLIENT_SLOTS);
+
+    for (int i = 0; i <= WAKE_CLIENT_SLOTS; i++)
+        close(fds[i]);
+    close_wake_sources(&cfg, &ws);
+}
+
+TEST(test_wake_client_refilled_slot_not_evicted_first) {
+    /* A client that refilled a freed slot is newer than the clients after it */
+    wake_s ws;
+    config_s cfg = { .wake_socket = "", .wake_file = "", .wake_gid = -1 };
+    ASSERT_EQ(open_wake_sources(&cfg, &ws), 0);
+    struct sockaddr_un addr;
+    socklen_t len;
+    ws.socket_fd = open_test_wake_listener(&addr, &len);
+    ASSERT_TRUE(ws.socket_fd >= 0);
+
+    /* Fill all slots in order, then free slot 5 and refill it */
+    int fds[WAKE_CLIENT_SLOTS * 2];
+    int n = 0;
+    for (; n < WAKE_CLIENT_SLOTS; n++) {
+        int sock = connect_wake_client(&addr, len);
+        ASSERT_TRUE(sock >= 0);
+        serve_wake_clients(&ws);
+        fds[n] = recv_wake_fd(sock);
+        ASSERT_TRUE(fds[n] >= 0);
+    }
+    close(fds[5]);
+    drop_wake_client(&ws, 5);
+    int refilled = n;
+    int sock = connect_wake_client(&addr, len);
+    ASSERT_TRUE(sock >= 0);
+    serve_wake_clients(&ws);
+    fds[n++] = recv_wake_fd(sock);
+    ASSERT_TRUE(fds[refilled] >= 0 && ws.client_fds[5] >= 0);
+
+    /* Seven more clients evict the seven original ones, not the refilled slot */
+    for (int i = 0; i < WAKE_CLIENT_SLOTS - 1; i++, n++) {
+        sock = connect_wake_client(&addr, len);
+        ASSERT_TRUE(sock >= 0);
+        serve_wake_clients(&ws);
+        fds[n] = recv_wake_fd(sock);
+        ASSERT_TRUE(fds[n] >= 0);
+    }
+    uint64_t one = 1;
+    ASSERT_EQ(write(fds[refilled], &one, sizeof(one)), (ssize_t)sizeof(one));
+    ASSERT_TRUE(drain_wake_fd(ws.client_fds[5]));
+    for (int i = 0; i < WAKE_CLIENT_SLOTS; i++) {
+        if (i == 5)
+            continue;
+        ASSERT_EQ(write(fds[i], &one, sizeof(one)), -1);
+        ASSERT_EQ(errno, EPIPE);
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (i != 5)
+            close(fds[i]);
+    }
+    close_wake_sources(&cfg, &ws);
+}
+
+TEST(test_split_wake_path_file) {
+    char dir[WAKE_PATH_LEN], name[WAKE_PATH_LEN];
+    split_wake_path("/nonexistent-dir/wake", dir, name);
+    ASSERT_EQ(strcmp(dir, "/nonexistent-dir"), 0);
+    ASSERT_EQ(strcmp(name, "wake"), 0);
+}
+
+TEST(test_split_wake_path_root_file) {
+    char dir[WAKE_PATH_LEN], name[WAKE_PATH_LEN];
+    split_wake_path("/nonexistent-wake", dir, name);
+    ASSERT_EQ(strcmp(dir, "/"), 0);
+    ASSERT_EQ(strcmp(name, "nonexistent-wake"), 0);
+}
+
+TEST(test_split_wake_path_existing_dir) {
+    /* Existing directory is watched as-is, any entry wakes */
+    char dir[WAKE_PATH_LEN], name[WAKE_PATH_LEN];
+    split_wake_path("/tmp", dir, name);
+    ASSERT_EQ(strcmp(dir, "/tmp"), 0);
+    ASSERT_EQ(name[0], '\0');
+}
+
+TEST(test_create_wake_file_group_writable) {
+    char path[] = "/tmp/test_wake_XXXXXX";
+    int tmp = mkstemp(path);
+    ASSERT_TRUE(tmp >= 0);
+    close(tmp);
+    unlink(path);
+
+    mode_t old_umask = umask(022);
+    int ret = create_wake_file(path, (int)getgid());
+    umask(old_umask);
+    ASSERT_EQ(ret, 0);
+
+    /* Group-writable, never world-writable */
+    struct stat st;
+    ASSERT_EQ(stat(path, &st), 0);
+    ASSERT_EQ(st.st_mode & 0777, WAKE_FILE_MODE);
+    ASSERT_EQ(st.st_mode & S_IWOTH, 0);
+    ASSERT_EQ(st.st_gid, getgid());
+    unlink(path);
+}
+
+TEST(test_create_wake_file_refuses_symlink) {
+    char path[] = "/tmp/test_wake_XXXXXX";
+    int tmp = mkstemp(path);
+    ASSERT_TRUE(tmp >= 0);
+    close(tmp);
+    unlink(path);
+    ASSERT_EQ(symlink("/tmp", path), 0);
+
+    ASSERT_EQ(create_wake_file(path, -1), -1);
+    unlink(path);
+}
+
+TEST(test_wake_event_matches) {
+    union {
+        struct inotify_event ev;
+        char buf[sizeof(struct inotify_event) + 16];
+    } u;
+    memset(&u, 0, sizeof(u));
+    u.ev.len = 16;
+    snprintf(u.ev.name, 16, "wake");
+
+    u.ev.mask = IN_ATTRIB;
+    ASSERT_TRUE(wake_event_matches(&u.ev, "wake"));
+    ASSERT_TRUE(wake_event_matches(&u.ev, ""));
+    ASSERT_TRUE(!wake_event_matches(&u.ev, "other"));
+
+    /* Events outside the mask never wake */
+    u.ev.mask = IN_DELETE;
+    ASSERT_TRUE(!wake_event_matches(&u.ev, "wake"));
+    ASSERT_TRUE(!wake_event_matches(&u.ev, ""));
+
+    /* Event on the directory itself has no name */
+    u.ev.mask = IN_ATTRIB;
+    u.ev.len = 0;
+    ASSERT_TRUE(!wake_event_matches(&u.ev, "wake"));
+}
+
+/* ==================== DEADLINE ALIGNMENT TESTS ==================== */
+
+TEST(test_align_timeout_disabled) {
+    ASSERT_EQ(align_timeout_ms(12345, 5000, 0), 5000);
+}
+
+TEST(test_align_timeout_infinite_unchanged) {
+    /* OFF state: no deadline to align */
+    ASSERT_EQ(align_timeout_ms(12345, -1, 10000), -1);
+}
+
+TEST(test_align_timeout_rounds_up) {
+    /* Deadline 12345 + 5000 = 17345 -> next 10s boundary 20000 */
+    ASSERT_EQ(align_timeout_ms(12345, 5000, 10000), 20000 - 12345);
+}
+
+TEST(test_align_timeout_on_boundary_unchanged) {
+    /* Deadline already on boundary: no extra delay */
+    ASSERT_EQ(align_timeout_ms(15000, 5000, 10000), 5000);
+}
+
+TEST(test_align_timeout_never_earlier) {
+    /* Aligned deadline is never before requested deadline */
+    for (uint64_t now = 0; now < 3000; now += 7) {
+        int t = align_timeout_ms(now, 1000, 1000);
+        ASSERT_TRUE(t >= 1000 && t < 2000);
+        ASSERT_EQ((now + (uint64_t)t) % 1000, 0);
+    }
+}
+
+TEST(test_align_timeout_max_values_fit_int) {
+    int t = align_timeout_ms(1, MAX_TIMEOUT_SEC * 1000, MAX_ALIGN_SEC * 1000U);
+    ASSERT_TRUE(t >= MAX_TIMEOUT_SEC * 1000);
+    ASSERT_TRUE(t <= (MAX_TIMEOUT_SEC + MAX_ALIGN_SEC) * 1000);
+}
+
+/* ==================== EARLY-BOOT HANDOFF TESTS ==================== */
+
+TEST(test_get_brightness_reads_sysfs_format) {
+    /* sysfs value with trailing newline, read from offset 0 */
+    char path[] = "/tmp/test_bl_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_TRUE(fd >= 0);
+    unlink(path);
+
+    ASSERT_EQ(write(fd, "128\n", 4), 4);
+    ASSERT_EQ(get_brightness(fd), 128);
+    ASSERT_EQ(set_brightness(fd, 200), 0);
+    ASSERT_EQ(get_brightness(fd), 200);
+
+    ASSERT_EQ(ftruncate(fd, 0), 0);
+    ASSERT_EQ(get_brightness(fd), -1);
+    close(fd);
+}
+
+TEST(test_restore_dimmed_keeps_timestamp) {
+    state_s st;
+    state_init(&st, BRIGHT_FULL, BRIGHT_DIM, DIM_SEC, OFF_SEC);
+
+    int brightness = state_restore(&st, STATE_DIMMED, 100);
+
+    ASSERT_EQ(brightness, BRIGHT_DIM);
+    ASSERT_EQ(st.state, STATE_DIMMED);
+    ASSERT_EQ(st.last_touch_sec, 100);
+    /* Continues toward OFF from the early instance's last touch */
+    ASSERT_EQ(state_get_timeout_sec(&st, 104), OFF_SEC - 4);
+}
+
+TEST(test_get_last_touch) {
+    state_s st;
+    state_init(&st, BRIGHT_FULL, BRIGHT_DIM, DIM_SEC, OFF_SEC);
+
+    state_touch(&st, 42);
+    ASSERT_EQ(state_get_last_touch(&st), 42);
+
+    state_restore(&st, STATE_DIMMED, 77);
+    ASSERT_EQ(state_get_last_touch(&st), 77);
+}
+
+TEST(test_restore_off) {
+    state_s st;
+    state_init(&st, BRIGHT_FULL, BRIGHT_DIM, DIM_SEC, OFF_SEC);
+
+    ASSERT_EQ(state_restore(&st, STATE_OFF, 50), 0);
+    ASSERT_EQ(state_get_timeout_sec(&st, 60), -1);
+}
+
+TEST(test_restore_invalid_state_falls_back_to_full) {
+    state_s st;
+    state_init(&st, BRIGHT_FULL, BRIGHT_DIM, DIM_SEC, OFF_SEC);
+
+    ASSERT_EQ(state_restore(&st, (state_e)42, 7), BRIGHT_FULL);
+    ASSERT_EQ(st.state, STATE_FULL);
+}
+
+TEST(test_restore_overdue_transitions_on_timeout) {
+    /* Service instance started after dim deadline passed */
+    state_s st;
+    state_init(&st, BRIGHT_FULL, BRIGHT_DIM, DIM_SEC, OFF_SEC);
+    state_restore(&st, STATE_FULL, 0);
+
+    ASSERT_EQ(state_get_timeout_sec(&st, 8), 0);
+    ASSERT_EQ(state_timeout(&st, 8), BRIGHT_DIM);
+}
+
+static void make_handoff(handoff_s *ho) {
+    memset(ho, 0, sizeof(*ho));
+    ho->magic = HANDOFF_MAGIC;
+    ho->state = STATE_DIMMED;
+    ho->last_touch_sec = 1234;
+    ho->brightness = 15;
+    snprintf(ho->backlight, sizeof(ho->backlight), "rpi_backlight");
+    snprintf(ho->device, sizeof(ho->device), "event0");
+}
+
+TEST(test_validate_handoff_valid) {
+    handoff_s ho;
+    make_handoff(&ho);
+    ASSERT_TRUE(validate_handoff(&ho));
+}
+
+TEST(test_validate_handoff_rejects_bad_fields) {
+    handoff_s ho;
+
+    make_handoff(&ho);
+    ho.magic = 0;
+    ASSERT_TRUE(!validate_handoff(&ho));
+
+    make_handoff(&ho);
+    ho.state = STATE_OFF + 1;
+    ASSERT_TRUE(!validate_handoff(&ho));
+
+    make_handoff(&ho);
+    ho.brightness = -1;
+    ASSERT_TRUE(!validate_handoff(&ho));
+
+    make_handoff(&ho);
+    snprintf(ho.device, sizeof(ho.device), "../event0");
+    ASSERT_TRUE(!validate_handoff(&ho));
+}
+
+TEST(test_validate_handoff_terminates_names) {
+    /* Unterminated name is truncated, not read past the buffer */
+    handoff_s ho;
+    make_handoff(&ho);
+    memset(ho.backlight, 'a', sizeof(ho.backlight));
+    ASSERT_TRUE(validate_handoff(&ho));
+    ASSERT_EQ(strlen(ho.backlight), sizeof(ho.backlight) - 1);
+}
+
+TEST(test_validate_handoff_fds) {
+    char path[] = "/tmp/test_handoff_XXXXXX";
+    int file_fd = mkstemp(path);
+    ASSERT_TRUE(file_fd >= 0);
+    unlink(path);
+    int chr_fd = open("/dev/null", O_RDONLY);
+    ASSERT_TRUE(chr_fd >= 0);
+    int efd = eventfd(0, 0);
+    ASSERT_TRUE(efd >= 0);
+
+    int good[MAX_PASSED_FDS] = { file_fd, chr_fd };
+    int swapped[MAX_PASSED_FDS] = { chr_fd, file_fd };
+    int bogus[MAX_PASSED_FDS] = { efd, chr_fd };
+    int missing[MAX_PASSED_FDS] = { file_fd, -1 };
+    ASSERT_TRUE(validate_handoff_fds(good));
+    ASSERT_TRUE(!validate_handoff_fds(swapped));
+    ASSERT_TRUE(!validate_handoff_fds(bogus));
+    ASSERT_TRUE(!validate_handoff_fds(missing));
+
+    close(file_fd);
+    close(chr_fd);
+    close(efd);
+}
+
+TEST(test_handoff_fds_round_trip) {
+    /* Message and both fds arrive intact over SOCK_SEQPACKET */
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv), 0);
+    int efd_a = eventfd(0, EFD_NONBLOCK);
+    int efd_b = eventfd(0, EFD_NONBLOCK);
+    ASSERT_TRUE(efd_a >= 0 && efd_b >= 0);
+
+    handoff_s out, in;
+    make_handoff(&out);
+    int send[MAX_PASSED_FDS] = { efd_a, efd_b };
+    ASSERT_EQ(send_fds(sv[0], &out, sizeof(out), send, MAX_PASSED_FDS), 0);
+
+    int recv[MAX_PASSED_FDS];
+    ASSERT_EQ(recv_fds(sv[1], &in, sizeof(in), recv, MAX_PASSED_FDS), MAX_PASSED_FDS);
+    ASSERT_TRUE(validate_handoff(&in));
+    ASSERT_EQ(in.last_touch_sec, 1234);
+    ASSERT_EQ(strcmp(in.device, "event0"), 0);
+
+    /* Received fds refer to the same eventfds */
+    uint64_t one = 1;
+    ASSERT_EQ(write(recv[1], &one, sizeof(one)), (ssize_t)sizeof(one));
+    ASSERT_TRUE(!drain_wake_fd(efd_a));
+    ASSERT_TRUE(drain_wake_fd(efd_b));
+
+    close(recv[0]);
+    close(recv[1]);
+    close(efd_a);
+    close(efd_b);
+    close(sv[0]);
+    close(sv[1]);
+}
+
+TEST(test_handoff_short_message_rejected) {
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv), 0);
+    int efd = eventfd(0, EFD_NONBLOCK);
+    ASSERT_TRUE(efd >= 0);
+
+    ASSERT_EQ(send_fds(sv[0], "W", 1, &efd, 1), 0);
+
+    handoff_s in;
+    int recv[MAX_PASSED_FDS];
+    ASSERT_EQ(recv_fds(sv[1], &in, sizeof(in), recv, MAX_PASSED_FDS), -1);
+    ASSERT_EQ(errno, EBADMSG);
+    ASSERT_EQ(recv[0], -1);
+
+    close(efd);
+    close(sv[0]);
+    close(sv[1]);
+}
+
+TEST(test_recv_fds_extra_fds_rejected) {
+    /* max_fds == 1 still has room for 2 fds after CMSG_SPACE padding */
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv), 0);
+    int efd_a = eventfd(0, EFD_NONBLOCK);
+    int efd_b = eventfd(0, EFD_NONBLOCK);
+    ASSERT_TRUE(efd_a >= 0 && efd_b >= 0);
+
+    char byte = 'W';
+    int send[MAX_PASSED_FDS] = { efd_a, efd_b };
+    ASSERT_EQ(send_fds(sv[0], &byte, 1, send, MAX_PASSED_FDS), 0);
+
+    int recv[2] = { -1, 12345 };
+    ASSERT_EQ(recv_fds(sv[1], &byte, 1, recv, 1), -1);
+    ASSERT_EQ(errno, EBADMSG);
+    ASSERT_EQ(recv[0], -1);
+    ASSERT_EQ(recv[1], 12345);
+
+    close(efd_a);
+    close(efd_b);
+    close(sv[0]);
+    close(sv[1]);
+}
+
+TEST(test_handoff_closed_peer_is_retryable) {
+    /* Early instance exited without sending: service reconnects, not EBADMSG */
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv), 0);
+    close(sv[0]);
+
+    handoff_s in;
+    int recv[MAX_PASSED_FDS];
+    ASSERT_EQ(recv_fds(sv[1], &in, sizeof(in), recv, MAX_PASSED_FDS), -1);
+    ASSERT_EQ(errno, ECONNRESET);
+    close(sv[1]);
+}
+
+TEST(test_serve_handoff_exits_on_closed_peer) {
+    /* Peer hung up before the send: EPIPE, no SIGPIPE, early instance still exits */
+    int listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0);
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    socklen_t len = sizeof(sa_family_t);
+    ASSERT_TRUE(listen_fd >= 0);
+    ASSERT_EQ(bind(listen_fd, (struct sockaddr *)&addr, len), 0);  /* Autobind */
+    ASSERT_EQ(listen(listen_fd, 1), 0);
+    len = sizeof(addr);
+    ASSERT_EQ(getsockname(listen_fd, (struct sockaddr *)&addr, &len), 0);
+
+    int peer = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    ASSERT_TRUE(peer >= 0);
+    ASSERT_EQ(connect(peer, (struct sockaddr *)&addr, len), 0);
+    close(peer);
+
+    int dev = open("/dev/null", O_RDWR);
+    ASSERT_TRUE(dev >= 0);
+    handoff_s out;
+    make_handoff(&out);
+    ASSERT_TRUE(serve_handoff(listen_fd, &out, dev, dev));
+
+    /* No peer pending: nothing to serve, keep running */
+    ASSERT_TRUE(!serve_handoff(listen_fd, &out, dev, dev));
+
+    close(dev);
+    close(listen_fd);
+}
+
 /* ==================== MAIN TEST RUNNER ==================== */
 
 int main(void) {
@@ -587,6 +1238,50 @@ int main(void) {
     RUN_TEST(test_validate_device_name_rejects_too_long);
     RUN_TEST(test_validate_device_name_accepts_max_minus_one);
 
+    printf("\nWake sources:\n");
+    RUN_TEST(test_validate_wake_path_valid);
+    RUN_TEST(test_validate_wake_path_rejects_relative);
+    RUN_TEST(test_validate_wake_path_rejects_dotdot);
+    RUN_TEST(test_validate_wake_path_rejects_too_long);
+    RUN_TEST(test_wake_socket_refuses_non_socket);
+    RUN_TEST(test_wake_socket_replaces_stale_socket);
+    RUN_TEST(test_wake_client_own_fd);
+    RUN_TEST(test_wake_client_full_queue_is_one_wake);
+    RUN_TEST(test_wake_client_hangup_frees_slot);
+    RUN_TEST(test_wake_client_slots_evict_oldest);
+    RUN_TEST(test_wake_client_refilled_slot_not_evicted_first);
+    RUN_TEST(test_split_wake_path_file);
+    RUN_TEST(test_split_wake_path_root_file);
+    RUN_TEST(test_split_wake_path_existing_dir);
+    RUN_TEST(test_create_wake_file_group_writable);
+    RUN_TEST(test_create_wake_file_refuses_symlink);
+    RUN_TEST(test_wake_event_matches);
+
+    printf("\nDeadline alignment:\n");
+    RUN_TEST(test_align_timeout_disabled);
+    RUN_TEST(test_align_timeout_infinite_unchanged);
+    RUN_TEST(test_align_timeout_rounds_up);
+    RUN_TEST(test_align_timeout_on_boundary_unchanged);
+    RUN_TEST(test_align_timeout_never_earlier);
+    RUN_TEST(test_align_timeout_max_values_fit_int);
+
+    printf("\nEarly-boot handoff:\n");
+    RUN_TEST(test_get_brightness_reads_sysfs_format);
+    RUN_TEST(test_restore_dimmed_keeps_timestamp);
+    RUN_TEST(test_get_last_touch);
+    RUN_TEST(test_restore_off);
+    RUN_TEST(test_restore_invalid_state_falls_back_to_full);
+    RUN_TEST(test_restore_overdue_transitions_on_timeout);
+    RUN_TEST(test_validate_handoff_valid);
+    RUN_TEST(test_validate_handoff_rejects_bad_fields);
+    RUN_TEST(test_validate_handoff_terminates_names);
+    RUN_TEST(test_validate_handoff_fds);
+    RUN_TEST(test_handoff_fds_round_trip);
+    RUN_TEST(test_handoff_short_message_rejected);
+    RUN_TEST(test_recv_fds_extra_fds_rejected);
+    RUN_TEST(test_handoff_closed_peer_is_retryable);
+    RUN_TEST(test_serve_handoff_exits_on_closed_peer);
+
     printf("\n========================================\n");
     printf("Results: %d/%d passed", tests_passed, tests_run);
     if (tests_failed > 0) {